@@ -2,22 +2,30 @@
 #define CHANNELPROCESSOR_HPP
 
 #include "VectorUtils.hpp"
+#include "ResultCache.hpp"
 
 /**
  * Implementation of the Channel Processing System.
  * 
  * This class provides a generic, parameterized channel processor that can work with any input that 
  * makes sense for such an application. 
+ * 
+ * Intermediate and final results are memoized, keyed by the parameters, and dropped whenever the 
+ * channel values change, so repeated metrics on unchanged data are served from the cache. The *Shared 
+ * variants return the cached vectors without copying them.
 */
 template <typename DataType>
 class ChannelProcessor {
 private:
     using TemplateVector = std::vector<DataType>;
     using V = VectorUtils<DataType>;
+    using Cache = ResultCache<DataType>;
+    using SharedVector = std::shared_ptr<const TemplateVector>;
 
     TemplateVector X;
     DataType m;
     DataType c;
+    Cache cache{SystemConstants::ResultCacheBudget};
     
     /**
      * Set the channel values and the parameters from file. 
@@ -33,6 +41,10 @@ private:
         c = params['c'];
     }
 
+    inline typename Cache::Key key(char metric, bool simd) const {
+        return {m, c, metric, simd};
+    }
+
 public:
     ChannelProcessor(const std::string& channelsFile, const std::string& paramsFile) {
         initializeFromFile(channelsFile, paramsFile);
@@ -42,58 +54,118 @@ public:
      * Clear the channel values and restore them from file.
      * 
      * The idea is that, our values may change over the course of time, and we need a versatile way 
-     * to fetch the updates and re-calculate the necessary metrics.
+     * to fetch the updates and re-calculate the necessary metrics. Cached results are dropped 
+     * only if the channel values or the parameters actually changed. The values are compared 
+     * bitwise, like the parameters in the cache keys, so NaN channels don't defeat the cache.
     */
     inline void fetchData(const std::string& channelsFile, const std::string& paramsFile) {
-        X.clear();
+        const typename Cache::Key previousKey = key(0, false);
+        TemplateVector previousX;
+        previousX.swap(X);
         initializeFromFile(channelsFile, paramsFile);
+
+        const bool sameX = X.size() == previousX.size() 
+            && std::memcmp(X.data(), previousX.data(), X.size() * sizeof(DataType)) == 0;
+        if (!sameX || !(key(0, false) == previousKey)) {
+            cache.clear();
+        }
     }
 
     /**
      * Function1 as described in the assignment: Y = mX + c
     */
     inline TemplateVector function1(const bool& simd = false) {
-        if (simd) {
-            return std::move(V::LinearTransformationSIMD(X, m, c));
-        } else {
-            return std::move(V::LinearTransformation(X, m, c));
+        return *function1Shared(simd);
+    }
+
+    /**
+     * Return the cached Y without copying it. The vector stays valid even after its entry is evicted.
+    */
+    inline SharedVector function1Shared(const bool& simd = false) {
+        const auto k = key('Y', simd);
+        if (auto hit = cache.find(k)) {
+            return hit->vector;
         }
+
+        auto Y = std::make_shared<const TemplateVector>(
+            simd ? V::LinearTransformationSIMD(X, m, c) : V::LinearTransformation(X, m, c));
+        cache.put(k, Y);
+        return Y;
     }
 
     /**
      * Function2 as described in the assignment: b = mean(A + Y)
     */
     inline double function2(const bool& simd = false) {
-        TemplateVector A = function3();
-        TemplateVector Y = function1(simd);
+        const auto k = key('b', simd);
+        if (auto hit = cache.find(k)) {
+            return hit->scalar;
+        }
+
+        SharedVector A = function3Shared();
+        SharedVector Y = function1Shared(simd);
+        double b;
 
         if (simd) {
-            TemplateVector Q = V::AddSIMD(A, Y);
-            return std::move(V::MeanSIMD(Q));
+            TemplateVector Q = V::AddSIMD(*A, *Y);
+            b = V::MeanSIMD(Q);
         } else {
-            TemplateVector Q = V::Add(A, Y);
-            return std::move(V::Mean(Q));
+            TemplateVector Q = V::Add(*A, *Y);
+            b = V::Mean(Q);
         }
+
+        cache.put(k, b);
+        return b;
     }
 
     /**
      * Function3 as described in the assignment: A = 1 / X
     */
     inline TemplateVector function3() {
-        TemplateVector A = V::Reciprocal(X);
-        return std::move(A);
+        return *function3Shared();
+    }
+
+    /**
+     * Return the cached A without copying it. The vector stays valid even after its entry is evicted.
+    */
+    inline SharedVector function3Shared() {
+        const auto k = key('A', false);
+        if (auto hit = cache.find(k)) {
+            return hit->vector;
+        }
+
+        auto A = std::make_shared<const TemplateVector>(V::Reciprocal(X));
+        cache.put(k, A);
+        return A;
     }
 
     /**
      * Function1 as described in the assignment: C = X + b
     */
     inline TemplateVector function4(const bool& simd) {
-        double b = function2(simd);
-        if (simd) {
-            return std::move(V::AddSIMD(X, b));
-        } else {
-            return std::move(V::Add(X, b));
+        return *function4Shared(simd);
+    }
+
+    /**
+     * Return the cached C without copying it. The vector stays valid even after its entry is evicted.
+    */
+    inline SharedVector function4Shared(const bool& simd) {
+        const auto k = key('C', simd);
+        if (auto hit = cache.find(k)) {
+            return hit->vector;
         }
+
+        double b = function2(simd);
+        auto C = std::make_shared<const TemplateVector>(simd ? V::AddSIMD(X, b) : V::Add(X, b));
+        cache.put(k, C);
+        return C;
+    }
+
+    /**
+     * Number of results currently held in the cache.
+    */
+    inline size_t cachedResults() const {
+        return cache.size();
     }
 
 };
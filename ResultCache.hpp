@@ -0,0 +1,175 @@
+#ifndef RESULTCACHE_HPP
+#define RESULTCACHE_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Memoization cache for the results of the channel processor.
+ *
+ * Entries are identified by the parameters (m, c), the metric that produced them and whether the 
+ * SIMD kernels were used. The cache doesn't know about the channel values: its owner clears it 
+ * whenever they change. Both vector results
+ * (Y, A, C) and scalar results (b) can be stored. Vectors are shared rather than copied, so a hit 
+ * costs a lookup regardless of their size. The cache keeps the most recently used
+ * entries, evicting the least recently used ones once the memory budget is exceeded.
+*/
+template <typename DataType>
+class ResultCache {
+    using TemplateVector = std::vector<DataType>;
+
+public:
+    struct Key {
+        DataType m;
+        DataType c;
+        char metric;
+        bool simd;
+
+        /**
+         * The parameters are compared by their bit patterns, so that a NaN key matches itself 
+         * and 0.0 and -0.0 are kept apart.
+        */
+        bool operator==(const Key& other) const {
+            return bits(m) == bits(other.m) && bits(c) == bits(other.c)
+                && metric == other.metric && simd == other.simd;
+        }
+    };
+
+    struct Entry {
+        std::shared_ptr<const TemplateVector> vector;
+        double scalar = 0.0;
+    };
+
+    /**
+     * Raw bit pattern of a parameter, zero extended to 64 bits.
+    */
+    inline static uint64_t bits(DataType value) {
+        static_assert(sizeof(DataType) <= sizeof(uint64_t), "Parameters must fit in 64 bits.");
+        uint64_t word = 0;
+        std::memcpy(&word, &value, sizeof(value));
+        return word;
+    }
+
+    explicit ResultCache(size_t budgetBytes) : budget(budgetBytes), used(0) {}
+
+    /**
+     * The index holds iterators into the entry list, so a copy has to rebuild it against its own 
+     * list. Moving a std::list keeps its iterators valid, so the defaults are fine for moves.
+    */
+    ResultCache(const ResultCache& other) : budget(other.budget), used(other.used), entries(other.entries) {
+        rebuildIndex();
+    }
+
+    ResultCache& operator=(const ResultCache& other) {
+        if (this != &other) {
+            budget = other.budget;
+            used = other.used;
+            entries = other.entries;
+            rebuildIndex();
+        }
+        return *this;
+    }
+
+    ResultCache(ResultCache&& other) = default;
+    ResultCache& operator=(ResultCache&& other) = default;
+
+    /**
+     * Return the cached entry for the key, or nullptr if it is not present.
+     * A hit marks the entry as the most recently used.
+    */
+    inline const Entry* find(const Key& key) {
+        auto it = index.find(key);
+        if (it == index.end()) {
+            return nullptr;
+        }
+        entries.splice(entries.begin(), entries, it->second);
+        return &it->second->second;
+    }
+
+    inline void put(const Key& key, std::shared_ptr<const TemplateVector> vector) {
+        Entry entry;
+        entry.vector = std::move(vector);
+        insert(key, std::move(entry));
+    }
+
+    inline void put(const Key& key, double scalar) {
+        Entry entry;
+        entry.scalar = scalar;
+        insert(key, std::move(entry));
+    }
+
+    inline void clear() {
+        entries.clear();
+        index.clear();
+        used = 0;
+    }
+
+    inline size_t size() const {
+        return entries.size();
+    }
+
+    inline size_t bytesUsed() const {
+        return used;
+    }
+
+private:
+    struct KeyHash {
+        size_t operator()(const Key& key) const {
+            uint64_t h = bits(key.m);
+            h ^= bits(key.c) + Golden + (h << 6) + (h >> 2);
+            h ^= (static_cast<uint64_t>(key.metric) << 1 | key.simd) + Golden + (h << 6) + (h >> 2);
+            return static_cast<size_t>(h);
+        }
+    };
+
+    using EntryList = std::list<std::pair<Key, Entry>>;
+
+    static constexpr uint64_t Golden = 0x9E3779B97F4A7C15ULL;
+
+    size_t budget;
+    size_t used;
+    EntryList entries;
+    std::unordered_map<Key, typename EntryList::iterator, KeyHash> index;
+
+    inline void rebuildIndex() {
+        index.clear();
+        for (auto it = entries.begin(); it != entries.end(); ++it) {
+            index.emplace(it->first, it);
+        }
+    }
+
+    inline static size_t footprint(const Entry& entry) {
+        const size_t vectorBytes = entry.vector ? entry.vector->size() * sizeof(DataType) : 0;
+        return sizeof(Key) + sizeof(Entry) + vectorBytes;
+    }
+
+    inline void insert(const Key& key, Entry&& entry) {
+        const size_t bytes = footprint(entry);
+        if (bytes > budget) {
+            return;
+        }
+
+        auto it = index.find(key);
+        if (it != index.end()) {
+            used -= footprint(it->second->second);
+            entries.erase(it->second);
+            index.erase(it);
+        }
+
+        while (used + bytes > budget && !entries.empty()) {
+            used -= footprint(entries.back().second);
+            index.erase(entries.back().first);
+            entries.pop_back();
+        }
+
+        entries.emplace_front(key, std::move(entry));
+        index.emplace(key, entries.begin());
+        used += bytes;
+    }
+};
+
+#endif
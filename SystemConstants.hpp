@@ -1,6 +1,7 @@
 #ifndef SYSTEMVARIABLES_HPP
 #define SYSTEMVARIABLES_HPP
 
+#include <cstddef>
 #include <string>
 
 /**
@@ -12,6 +13,7 @@ namespace SystemConstants {
     const double ZeroThreshold = 0.000000001;
     const double EqualityThreshold = 0.00001;
     const bool isSIMDSupported = false; 
+    const size_t ResultCacheBudget = 64 * 1024 * 1024;
 }
 
 #endif
\ No newline at end of file
@@ -27,8 +27,13 @@ template <typename DataType>
 class VectorUtils {
     using TemplateVector = std::vector<DataType>;
 
+    /**
+     * Number of elements that fit in a 256-bit AVX register.
+    */
+    static constexpr size_t Lanes = sizeof(__m256) / sizeof(DataType);
+
 public:
-    inline static TemplateVector LinearTransformation(TemplateVector& V, DataType a, DataType b) {
+    inline static TemplateVector LinearTransformation(const TemplateVector& V, DataType a, DataType b) {
         if (V.empty()) {
             throw std::runtime_error("Vector is empty.");
         }
@@ -43,7 +48,7 @@ public:
         return std::move(result);
     }
 
-    inline static DataType Mean(TemplateVector& V) {
+    inline static DataType Mean(const TemplateVector& V) {
         if (V.empty()) {
             throw std::runtime_error("Vector is empty.");
         }
@@ -51,7 +56,7 @@ public:
         return std::move(static_cast<double>(sum) / V.size());
     }
 
-    inline static TemplateVector Add(TemplateVector& V, TemplateVector& U) {
+    inline static TemplateVector Add(const TemplateVector& V, const TemplateVector& U) {
         if (V.size() != U.size()) {
             throw std::runtime_error("Vectors must have the same dimensions.");
         }
@@ -66,7 +71,7 @@ public:
         return std::move(result);
     }
 
-    inline static TemplateVector Add(TemplateVector& V, DataType b) {
+    inline static TemplateVector Add(const TemplateVector& V, DataType b) {
         if (V.empty()) {
             throw std::runtime_error("Vector is empty.");
         }
@@ -81,7 +86,7 @@ public:
         return std::move(result);
     }
 
-    inline static TemplateVector Reciprocal(TemplateVector& V) {
+    inline static TemplateVector Reciprocal(const TemplateVector& V) {
         DataType threshold = static_cast<DataType>(SystemConstants::ZeroThreshold);
         bool foundZero = std::any_of(V.begin(), V.end(), [threshold](const auto& v) {
             return v <= threshold; 
@@ -99,18 +104,18 @@ public:
         return std::move(result);
     }
 
-    inline static TemplateVector LinearTransformationSIMD(const TemplateVector V, DataType a, DataType b) {
+    inline static TemplateVector LinearTransformationSIMD(const TemplateVector& V, DataType a, DataType b) {
         if (V.empty()) {
             throw std::runtime_error("Vector is empty.");
         }
         const size_t size = V.size();
-        const size_t alignedSize = size - size % 8;
+        const size_t alignedSize = size - size % Lanes;
         std::vector<DataType> result(size);
         
         if constexpr (std::is_same<DataType, float>::value) {
             __m256 aVector = _mm256_set1_ps(a);
             __m256 bVector = _mm256_set1_ps(b);
-            for (size_t i = 0; i < alignedSize; i += 8 / sizeof(DataType)) {
+            for (size_t i = 0; i < alignedSize; i += Lanes) {
                 __m256 v = _mm256_loadu_ps(&V[i]);
                 __m256 transformed = _mm256_add_ps(_mm256_mul_ps(aVector, v), bVector);
                 _mm256_storeu_ps(&result[i], transformed);
@@ -118,7 +123,7 @@ public:
         } else if constexpr (std::is_same<DataType, double>::value) {
             __m256d aVector = _mm256_set1_pd(a);
             __m256d bVector = _mm256_set1_pd(b);
-            for (size_t i = 0; i < alignedSize; i += 4 / sizeof(DataType)) {
+            for (size_t i = 0; i < alignedSize; i += Lanes) {
                 __m256d v = _mm256_loadu_pd(&V[i]);
                 __m256d transformed = _mm256_add_pd(_mm256_mul_pd(aVector, v), bVector);
                 _mm256_storeu_pd(&result[i], transformed);
@@ -137,47 +142,70 @@ public:
         return std::move(result);
     }
 
-    inline static DataType MeanSIMD(TemplateVector V) {
+    inline static DataType MeanSIMD(const TemplateVector& V) {
         if (V.empty()) {
             throw std::runtime_error("Vector is empty.");
         }
 
-        size_t size = V.size();
-        size_t simdSize = sizeof(__m128) / sizeof(DataType);
-        size_t numIterations = size / simdSize;
-
+        const size_t size = V.size();
         DataType sum = DataType(0);
+        size_t i = 0;
+
+        // Sum into 4 vector accumulators to keep independent additions in flight, and reduce them 
+        // horizontally only once after the loop.
+        if constexpr (std::is_same<DataType, float>::value) {
+            __m256 acc[4] = {_mm256_setzero_ps(), _mm256_setzero_ps(), _mm256_setzero_ps(), _mm256_setzero_ps()};
+            for (; i + 4 * Lanes <= size; i += 4 * Lanes) {
+                for (size_t k = 0; k < 4; k++) {
+                    acc[k] = _mm256_add_ps(acc[k], _mm256_loadu_ps(&V[i + k * Lanes]));
+                }
+            }
+            for (; i + Lanes <= size; i += Lanes) {
+                acc[0] = _mm256_add_ps(acc[0], _mm256_loadu_ps(&V[i]));
+            }
+            __m256 total = _mm256_add_ps(_mm256_add_ps(acc[0], acc[1]), _mm256_add_ps(acc[2], acc[3]));
+            __m128 hSum = _mm_add_ps(_mm256_castps256_ps128(total), _mm256_extractf128_ps(total, 1));
+            hSum = _mm_hadd_ps(hSum, hSum);
+            hSum = _mm_hadd_ps(hSum, hSum);
+            sum = _mm_cvtss_f32(hSum);
 
-        for (int i = 0; i < numIterations; i++) {
-            const DataType* chunk = &V[i * simdSize];
-
-            if constexpr (std::is_same<DataType, float>::value) {
-                __m128 data = _mm_loadu_ps(chunk);
-                __m128 hSum = _mm_hadd_ps(data, data);
-                hSum = _mm_hadd_ps(hSum, hSum);
-                float floatSum;
-                _mm_store_ss(&floatSum, hSum);
-                sum += floatSum;
-
-            } else if constexpr (std::is_same<DataType, double>::value) {
-                __m128d data = _mm_loadu_pd(chunk);
-                __m128d hSum = _mm_hadd_pd(data, data);
-                double doubleSum;
-                _mm_store_sd(&doubleSum, hSum);
-                sum += doubleSum;
-
-            } else if constexpr (std::is_same<DataType, int>::value) {
-                __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(chunk));
-                __m128i hSum = _mm_hadd_epi32(data, data);
-                hSum = _mm_hadd_epi32(hSum, hSum);
-                int intSum;
-                _mm_store_si128(reinterpret_cast<__m128i*>(&intSum), hSum);
-                sum += intSum;
+        } else if constexpr (std::is_same<DataType, double>::value) {
+            __m256d acc[4] = {_mm256_setzero_pd(), _mm256_setzero_pd(), _mm256_setzero_pd(), _mm256_setzero_pd()};
+            for (; i + 4 * Lanes <= size; i += 4 * Lanes) {
+                for (size_t k = 0; k < 4; k++) {
+                    acc[k] = _mm256_add_pd(acc[k], _mm256_loadu_pd(&V[i + k * Lanes]));
+                }
+            }
+            for (; i + Lanes <= size; i += Lanes) {
+                acc[0] = _mm256_add_pd(acc[0], _mm256_loadu_pd(&V[i]));
+            }
+            __m256d total = _mm256_add_pd(_mm256_add_pd(acc[0], acc[1]), _mm256_add_pd(acc[2], acc[3]));
+            __m128d hSum = _mm_add_pd(_mm256_castpd256_pd128(total), _mm256_extractf128_pd(total, 1));
+            hSum = _mm_hadd_pd(hSum, hSum);
+            sum = _mm_cvtsd_f64(hSum);
+
+        } else if constexpr (std::is_same<DataType, int>::value) {
+            // 256-bit integer arithmetic needs AVX2, so integers use 128-bit registers.
+            const size_t intLanes = sizeof(__m128i) / sizeof(int);
+            __m128i acc[4] = {_mm_setzero_si128(), _mm_setzero_si128(), _mm_setzero_si128(), _mm_setzero_si128()};
+            for (; i + 4 * intLanes <= size; i += 4 * intLanes) {
+                for (size_t k = 0; k < 4; k++) {
+                    __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&V[i + k * intLanes]));
+                    acc[k] = _mm_add_epi32(acc[k], data);
+                }
+            }
+            for (; i + intLanes <= size; i += intLanes) {
+                __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&V[i]));
+                acc[0] = _mm_add_epi32(acc[0], data);
             }
+            __m128i hSum = _mm_add_epi32(_mm_add_epi32(acc[0], acc[1]), _mm_add_epi32(acc[2], acc[3]));
+            hSum = _mm_hadd_epi32(hSum, hSum);
+            hSum = _mm_hadd_epi32(hSum, hSum);
+            sum = _mm_cvtsi128_si32(hSum);
         }
 
-        // Handle remaining elements (not multiple of simdSize)
-        for (size_t i = numIterations * simdSize; i < size; i++) {
+        // Handle remaining elements (not a multiple of the register width)
+        for (; i < size; i++) {
             sum += V[i];
         }
 
@@ -185,25 +213,25 @@ public:
 
     }
 
-    inline static TemplateVector AddSIMD(TemplateVector V, TemplateVector U) {
+    inline static TemplateVector AddSIMD(const TemplateVector& V, const TemplateVector& U) {
         if (V.size() != U.size()) {
             throw std::runtime_error("Vectors must have the same dimensions.");
         }
 
         const size_t size = V.size();
-        const size_t alignedSize = size - size % 8;
+        const size_t alignedSize = size - size % Lanes;
 
         TemplateVector result(size);
 
         if constexpr (std::is_same<DataType, double>::value) {
-            for (size_t i = 0; i < alignedSize; i += 4 / sizeof(DataType)) {
+            for (size_t i = 0; i < alignedSize; i += Lanes) {
                 __m256d a = _mm256_loadu_pd(&V[i]);
                 __m256d b = _mm256_loadu_pd(&U[i]);
                 __m256d sum = _mm256_add_pd(a, b);
                 _mm256_storeu_pd(&result[i], sum);
             }
         } else if constexpr (std::is_same<DataType, float>::value) {
-            for (size_t i = 0; i < alignedSize; i += 8 / sizeof(DataType)) {
+            for (size_t i = 0; i < alignedSize; i += Lanes) {
                 __m256 a = _mm256_loadu_ps(&V[i]);
                 __m256 b = _mm256_loadu_ps(&U[i]);
                 __m256 sum = _mm256_add_ps(a, b);
@@ -223,26 +251,26 @@ public:
         return std::move(result);
     }
 
-    inline static TemplateVector AddSIMD(TemplateVector V, DataType b) {
+    inline static TemplateVector AddSIMD(const TemplateVector& V, DataType b) {
         if (V.empty()) {
             throw std::runtime_error("Vector is empty.");
         }
 
         const size_t size = V.size();
-        const size_t alignedSize = size - size % 8;
+        const size_t alignedSize = size - size % Lanes;
 
         TemplateVector result(size);
 
         if constexpr (std::is_same<DataType, double>::value) {
             __m256d scalarVector = _mm256_set1_pd(b);
-            for (size_t i = 0; i < alignedSize; i += 4 / sizeof(DataType)) {
+            for (size_t i = 0; i < alignedSize; i += Lanes) {
                 __m256d v = _mm256_loadu_pd(&V[i]);
                 __m256d sum = _mm256_add_pd(v, scalarVector);
                 _mm256_storeu_pd(&result[i], sum);
             }
         } else if constexpr (std::is_same<DataType, float>::value) {
             __m256 scalarVector = _mm256_set1_ps(b);
-            for (size_t i = 0; i < alignedSize; i += 8 / sizeof(DataType)) {
+            for (size_t i = 0; i < alignedSize; i += Lanes) {
                 __m256 v = _mm256_loadu_ps(&V[i]);
                 __m256 sum = _mm256_add_ps(v, scalarVector);
                 _mm256_storeu_ps(&result[i], sum);
@@ -0,0 +1,214 @@
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include "../Parser.hpp"
+#include "../ChannelProcessor.hpp"
+
+using fvec = std::vector<float>;
+
+class ChannelProcessorTest {
+public:
+    ChannelProcessorTest() {}
+
+    void testAll() {
+        testCachedResultsMatch();
+        testRepeatedMetricsHitCache();
+        testFetchUnchangedDataKeepsCache();
+        testFetchChangedDataInvalidatesCache();
+        testCacheEvictsLeastRecentlyUsed();
+        testCacheKeysCompareParameterBits();
+        testCopiedCacheOutlivesOriginal();
+        testCopiedProcessorOutlivesOriginal();
+    }
+
+    void testCachedResultsMatch() {
+        writeFiles("X, 1.5, 2.5, 4.0, 8.0, 0.5, 3.0", "m, 2.0\nc, 0.5");
+        ChannelProcessor<float> processor(ChannelsFile, ParametersFile);
+
+        float b1 = processor.function2(false);
+        fvec C1 = processor.function4(false);
+        float b2 = processor.function2(false);
+        fvec C2 = processor.function4(false);
+
+        assert(std::fabs(b1 - b2) <= SystemConstants::EqualityThreshold);
+        assert(VectorUtils<float>::VerifySameVectors(C1, C2));
+        removeFiles();
+    }
+
+    void testRepeatedMetricsHitCache() {
+        writeFiles("X, 1.5, 2.5, 4.0, 8.0, 0.5, 3.0", "m, 2.0\nc, 0.5");
+        ChannelProcessor<float> processor(ChannelsFile, ParametersFile);
+
+        // C depends on b, which depends on A and Y: all four are stored.
+        processor.function4(true);
+        assert(processor.cachedResults() == 4);
+
+        processor.function1(true);
+        processor.function2(true);
+        processor.function3();
+        processor.function4(true);
+        assert(processor.cachedResults() == 4);
+
+        // The scalar kernels are cached separately, A is shared.
+        processor.function4(false);
+        assert(processor.cachedResults() == 7);
+
+        // Hits hand out the cached vector itself instead of a copy.
+        assert(processor.function4Shared(false) == processor.function4Shared(false));
+        assert(processor.function1Shared(true) == processor.function1Shared(true));
+        assert(processor.function3Shared() == processor.function3Shared());
+        removeFiles();
+    }
+
+    void testFetchUnchangedDataKeepsCache() {
+        writeFiles("X, 1.5, 2.5, 4.0, 8.0, 0.5, 3.0", "m, 2.0\nc, 0.5");
+        ChannelProcessor<float> processor(ChannelsFile, ParametersFile);
+
+        processor.function4(false);
+        processor.fetchData(ChannelsFile, ParametersFile);
+        assert(processor.cachedResults() == 4);
+        removeFiles();
+    }
+
+    void testFetchChangedDataInvalidatesCache() {
+        writeFiles("X, 1.5, 2.5, 4.0, 8.0, 0.5, 3.0", "m, 2.0\nc, 0.5");
+        ChannelProcessor<float> processor(ChannelsFile, ParametersFile);
+        float b1 = processor.function2(false);
+
+        writeFiles("X, 1.5, 2.5, 4.0, 8.0, 0.5, 2.0", "m, 2.0\nc, 0.5");
+        processor.fetchData(ChannelsFile, ParametersFile);
+        assert(processor.cachedResults() == 0);
+        float b2 = processor.function2(false);
+        assert(std::fabs(b1 - b2) > SystemConstants::EqualityThreshold);
+
+        writeFiles("X, 1.5, 2.5, 4.0, 8.0, 0.5, 2.0", "m, 3.0\nc, 0.5");
+        processor.fetchData(ChannelsFile, ParametersFile);
+        assert(processor.cachedResults() == 0);
+        float b3 = processor.function2(false);
+        assert(std::fabs(b2 - b3) > SystemConstants::EqualityThreshold);
+        removeFiles();
+    }
+
+    void testCacheEvictsLeastRecentlyUsed() {
+        using Cache = ResultCache<float>;
+        const auto values = std::make_shared<const fvec>(100, 1.0f);
+        const size_t entryBytes = sizeof(Cache::Key) + sizeof(Cache::Entry) + values->size() * sizeof(float);
+        Cache cache(2 * entryBytes);
+
+        Cache::Key k1 = {1.0f, 0.5f, 'Y', false};
+        Cache::Key k2 = {2.0f, 0.5f, 'Y', false};
+        Cache::Key k3 = {3.0f, 0.5f, 'Y', false};
+
+        cache.put(k1, values);
+        cache.put(k2, values);
+        assert(cache.find(k1) != nullptr);
+
+        // k2 is now the least recently used and makes room for k3.
+        cache.put(k3, values);
+        assert(cache.size() == 2);
+        assert(cache.bytesUsed() <= 2 * entryBytes);
+        assert(cache.find(k1) != nullptr);
+        assert(cache.find(k2) == nullptr);
+        assert(cache.find(k3) != nullptr);
+
+        // Entries larger than the whole budget are never stored.
+        cache.put(k2, std::make_shared<const fvec>(1000, 1.0f));
+        assert(cache.find(k2) == nullptr);
+        assert(cache.size() == 2);
+    }
+
+    void testCacheKeysCompareParameterBits() {
+        using Cache = ResultCache<float>;
+        const auto values = std::make_shared<const fvec>(100, 1.0f);
+        const size_t entryBytes = sizeof(Cache::Key) + sizeof(Cache::Entry) + values->size() * sizeof(float);
+        Cache cache(2 * entryBytes);
+
+        const float nan = std::numeric_limits<float>::quiet_NaN();
+        Cache::Key k1 = {nan, 0.5f, 'Y', false};
+        Cache::Key k2 = {2.0f, nan, 'Y', false};
+
+        // Repeated puts of a NaN key replace the entry instead of piling up.
+        for (int i = 0; i < 10; i++) {
+            cache.put(k1, values);
+            assert(cache.find(k1) != nullptr);
+        }
+        assert(cache.size() == 1);
+
+        cache.put(k2, values);
+        cache.put(k2, values);
+        assert(cache.size() == 2);
+        assert(cache.bytesUsed() <= 2 * entryBytes);
+
+        // Evicting a NaN key must remove it from the index as well.
+        Cache::Key k3 = {3.0f, 0.5f, 'Y', false};
+        cache.put(k3, values);
+        assert(cache.size() == 2);
+        assert(cache.find(k1) == nullptr);
+        assert(cache.find(k2) != nullptr);
+
+        Cache::Key positiveZero = {0.0f, 0.5f, 'Y', false};
+        Cache::Key negativeZero = {-0.0f, 0.5f, 'Y', false};
+        cache.put(positiveZero, 1.0);
+        assert(cache.find(negativeZero) == nullptr);
+    }
+
+    void testCopiedCacheOutlivesOriginal() {
+        using Cache = ResultCache<float>;
+        const auto values = std::make_shared<const fvec>(100, 1.0f);
+        Cache::Key k1 = {1.0f, 0.5f, 'Y', false};
+        Cache::Key k2 = {2.0f, 0.5f, 'Y', false};
+
+        auto original = std::make_unique<Cache>(SystemConstants::ResultCacheBudget);
+        original->put(k1, values);
+        original->put(k2, 1.0);
+
+        Cache copy(*original);
+        Cache assigned(0);
+        assigned = *original;
+        original.reset();
+
+        for (Cache* cache : {&copy, &assigned}) {
+            assert(cache->size() == 2);
+            assert(cache->find(k1) != nullptr && cache->find(k1)->vector == values);
+            assert(cache->find(k2) != nullptr && cache->find(k2)->scalar == 1.0);
+            cache->put(k1, 2.0);
+            assert(cache->size() == 2);
+        }
+
+        Cache moved(std::move(copy));
+        assert(moved.find(k1) != nullptr && moved.find(k1)->scalar == 2.0);
+    }
+
+    void testCopiedProcessorOutlivesOriginal() {
+        writeFiles("X, 1.5, 2.5, 4.0, 8.0, 0.5, 3.0", "m, 2.0\nc, 0.5");
+        auto original = std::make_unique<ChannelProcessor<float>>(ChannelsFile, ParametersFile);
+        fvec Y1 = original->function1(false);
+
+        ChannelProcessor<float> copy(*original);
+        original.reset();
+
+        fvec Y2 = copy.function1(false);
+        assert(VectorUtils<float>::VerifySameVectors(Y1, Y2));
+        assert(copy.cachedResults() == 1);
+        removeFiles();
+    }
+
+private:
+    const std::string ChannelsFile = "./channels_test.txt";
+    const std::string ParametersFile = "./parameters_test.txt";
+
+    void writeFiles(const std::string& channels, const std::string& parameters) {
+        std::ofstream(ChannelsFile) << channels;
+        std::ofstream(ParametersFile) << parameters;
+    }
+
+    void removeFiles() {
+        std::remove(ChannelsFile.c_str());
+        std::remove(ParametersFile.c_str());
+    }
+};
+
+int main() {
+    ChannelProcessorTest channelProcessorTest;
+    channelProcessorTest.testAll();
+}
@@ -0,0 +1,139 @@
+#ifndef KERNELDIFFERENTIAL_HPP
+#define KERNELDIFFERENTIAL_HPP
+
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <string>
+#include "../VectorUtils.hpp"
+
+/**
+ * Comparison of the scalar and the SIMD kernels of VectorUtils on the same input.
+ * 
+ * Shared by the randomized sweep and the fuzz target. Every check runs both variants, treats a 
+ * thrown exception as part of the result and reports the first mismatch on stderr.
+*/
+template <typename DataType>
+class KernelDifferential {
+    using TemplateVector = std::vector<DataType>;
+    using V = VectorUtils<DataType>;
+
+public:
+    inline static bool CheckLinearTransformation(TemplateVector& X, DataType a, DataType b) {
+        return compareVectors("LinearTransformation", X.size(),
+            [&]() { return V::LinearTransformation(X, a, b); },
+            [&]() { return V::LinearTransformationSIMD(X, a, b); });
+    }
+
+    inline static bool CheckAddVectors(TemplateVector& X, TemplateVector& Y) {
+        return compareVectors("Add(vector)", X.size(),
+            [&]() { return V::Add(X, Y); },
+            [&]() { return V::AddSIMD(X, Y); });
+    }
+
+    inline static bool CheckAddScalar(TemplateVector& X, DataType b) {
+        return compareVectors("Add(scalar)", X.size(),
+            [&]() { return V::Add(X, b); },
+            [&]() { return V::AddSIMD(X, b); });
+    }
+
+    /**
+     * The two variants sum in a different order, so floating point results are only required to 
+     * agree within the error bound of recursive summation. The input must not overflow the sum.
+     * With exact set, the caller guarantees that every partial sum is representable (e.g. small 
+     * integer values), so both variants must return the same mean bit for bit.
+    */
+    inline static bool CheckMean(TemplateVector& X, bool exact = false) {
+        DataType scalar, simd;
+        bool scalarThrew = false, simdThrew = false;
+        try { scalar = V::Mean(X); } catch (const std::runtime_error& e) { scalarThrew = true; }
+        try { simd = V::MeanSIMD(X); } catch (const std::runtime_error& e) { simdThrew = true; }
+
+        if (scalarThrew || simdThrew) {
+            return reportThrow("Mean", X.size(), scalarThrew, simdThrew);
+        }
+
+        bool same;
+        if (exact) {
+            same = scalar == simd;
+        } else if constexpr (std::is_floating_point<DataType>::value) {
+            long double magnitude = 0;
+            for (const auto& x : X) {
+                magnitude += std::fabs(static_cast<long double>(x));
+            }
+            // Summation error is bounded by ~n * eps * sum|x|; the n cancels when dividing for the mean.
+            const long double bound = 2.0L * std::numeric_limits<DataType>::epsilon() * magnitude 
+                + std::numeric_limits<DataType>::denorm_min();
+            same = (std::isnan(scalar) && std::isnan(simd)) || scalar == simd
+                || std::fabs(static_cast<long double>(scalar) - simd) <= bound;
+        } else {
+            same = scalar == simd;
+        }
+
+        if (!same) {
+            std::cerr << "Mean mismatch for size " << X.size() << ": scalar " << scalar 
+                << ", SIMD " << simd << "\n";
+        }
+        return same;
+    }
+
+    /**
+     * Elementwise equality within a few ulps. Build with -ffp-contract=off, otherwise the compiler 
+     * may fuse a * x + b in the scalar loop only and cancellation makes the difference unbounded.
+    */
+    inline static bool Close(DataType x, DataType y) {
+        if constexpr (std::is_floating_point<DataType>::value) {
+            if (x == y || (std::isnan(x) && std::isnan(y))) {
+                return true;
+            }
+            if (!std::isfinite(x) || !std::isfinite(y)) {
+                return false;
+            }
+            const DataType scale = std::max(std::fabs(x), std::fabs(y));
+            return std::fabs(x - y) <= 4 * std::numeric_limits<DataType>::epsilon() * scale 
+                + 4 * std::numeric_limits<DataType>::denorm_min();
+        } else {
+            return x == y;
+        }
+    }
+
+private:
+    inline static bool compareVectors(const std::string& kernel, size_t size, 
+            const std::function<TemplateVector()>& scalarKernel, 
+            const std::function<TemplateVector()>& simdKernel) {
+        TemplateVector scalar, simd;
+        bool scalarThrew = false, simdThrew = false;
+        try { scalar = scalarKernel(); } catch (const std::runtime_error& e) { scalarThrew = true; }
+        try { simd = simdKernel(); } catch (const std::runtime_error& e) { simdThrew = true; }
+
+        if (scalarThrew || simdThrew) {
+            return reportThrow(kernel, size, scalarThrew, simdThrew);
+        }
+
+        if (scalar.size() != simd.size()) {
+            std::cerr << kernel << " size mismatch for size " << size << ": scalar " << scalar.size() 
+                << ", SIMD " << simd.size() << "\n";
+            return false;
+        }
+
+        for (size_t i = 0; i < scalar.size(); i++) {
+            if (!Close(scalar[i], simd[i])) {
+                std::cerr << kernel << " mismatch for size " << size << " at index " << i 
+                    << ": scalar " << scalar[i] << ", SIMD " << simd[i] << "\n";
+                return false;
+            }
+        }
+        return true;
+    }
+
+    inline static bool reportThrow(const std::string& kernel, size_t size, bool scalarThrew, bool simdThrew) {
+        if (scalarThrew != simdThrew) {
+            std::cerr << kernel << " for size " << size << ": only the " 
+                << (scalarThrew ? "scalar" : "SIMD") << " variant threw\n";
+            return false;
+        }
+        return true;
+    }
+};
+
+#endif
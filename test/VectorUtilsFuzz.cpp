@@ -0,0 +1,117 @@
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include "KernelDifferential.hpp"
+
+/**
+ * libFuzzer target comparing the scalar and SIMD kernels of VectorUtils.
+ * 
+ * Input layout: one byte selecting the data type, one byte selecting the kernel, the parameters 
+ * a and b, then the vector values, all as raw bytes of the selected type. The bytes after the 
+ * first half of the values are used as the second operand of the vector addition.
+ * 
+ * Build with clang++ -std=c++17 -O1 -g -mavx -ffp-contract=off -fsanitize=fuzzer,address,undefined VectorUtilsFuzz.cpp
+*/
+
+namespace {
+
+template <typename DataType>
+DataType read(const uint8_t*& data, size_t& size) {
+    DataType value = DataType(0);
+    const size_t bytes = std::min(size, sizeof(DataType));
+    std::memcpy(&value, data, bytes);
+    data += bytes;
+    size -= bytes;
+    return value;
+}
+
+/**
+ * Integer inputs are folded into a small range, since overflowing an int is undefined behaviour 
+ * in both variants rather than a difference between them.
+*/
+template <typename DataType>
+DataType sanitize(DataType value) {
+    if constexpr (std::is_integral<DataType>::value) {
+        return value % 1001;
+    } else {
+        return value;
+    }
+}
+
+/**
+ * The mean is compared only on inputs whose sum cannot overflow, see KernelDifferential::CheckMean.
+*/
+template <typename DataType>
+bool summable(const std::vector<DataType>& X) {
+    if constexpr (std::is_floating_point<DataType>::value) {
+        const DataType limit = std::numeric_limits<DataType>::max() / (X.size() + 1);
+        return std::all_of(X.begin(), X.end(), [limit](const auto& x) {
+            return std::isfinite(x) && std::fabs(x) <= limit;
+        });
+    } else {
+        return true;
+    }
+}
+
+template <typename DataType>
+void fuzzKernel(uint8_t kernel, const uint8_t* data, size_t size) {
+    using D = KernelDifferential<DataType>;
+
+    DataType a = sanitize(read<DataType>(data, size));
+    DataType b = sanitize(read<DataType>(data, size));
+
+    std::vector<DataType> X(size / sizeof(DataType));
+    for (auto& x : X) {
+        x = sanitize(read<DataType>(data, size));
+    }
+
+    bool same = true;
+    switch (kernel % 4) {
+        case 0:
+            same = D::CheckLinearTransformation(X, a, b);
+            break;
+        case 1: {
+            std::vector<DataType> U(X.begin() + X.size() / 2, X.end());
+            std::vector<DataType> W(X.begin(), X.begin() + U.size());
+            same = D::CheckAddVectors(W, U);
+            break;
+        }
+        case 2:
+            same = D::CheckAddScalar(X, b);
+            break;
+        case 3:
+            if (summable(X)) {
+                same = D::CheckMean(X);
+            }
+            break;
+    }
+
+    if (!same) {
+        std::abort();
+    }
+}
+
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    if (size < 2) {
+        return 0;
+    }
+
+    const uint8_t type = data[0];
+    const uint8_t kernel = data[1];
+
+    switch (type % 3) {
+        case 0:
+            fuzzKernel<float>(kernel, data + 2, size - 2);
+            break;
+        case 1:
+            fuzzKernel<double>(kernel, data + 2, size - 2);
+            break;
+        case 2:
+            fuzzKernel<int>(kernel, data + 2, size - 2);
+            break;
+    }
+
+    return 0;
+}
@@ -0,0 +1,193 @@
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <random>
+#include "KernelDifferential.hpp"
+
+/**
+ * Randomized sweep comparing the scalar and SIMD kernels of VectorUtils.
+ * 
+ * Covers every length up to a few registers, the lengths around each power of 2 and random 
+ * lengths up to 10^6, for float, double and int, with regular, denormal and extreme values.
+ * It also times both variants on large inputs and fails if a SIMD kernel is slower than its 
+ * scalar counterpart.
+ * 
+ * Build with optimizations (-O2 or -O3) and AVX enabled, e.g. g++ -std=c++17 -O3 -mavx -ffp-contract=off.
+*/
+class VectorUtilsPropertyTest {
+public:
+    VectorUtilsPropertyTest() : rng(20231018) {}
+
+    void testAll() {
+        testSweep<float>();
+        testSweep<double>();
+        testSweep<int>();
+        testSIMDNotSlower<float>();
+        testSIMDNotSlower<double>();
+        testSIMDNotSlower<int>();
+    }
+
+    template <typename DataType>
+    void testSweep() {
+        for (size_t size : sweepSizes()) {
+            for (Distribution distribution : {Regular, Denormal, Extreme, IntegerValued}) {
+                checkAllKernels<DataType>(size, distribution);
+            }
+        }
+    }
+
+    /**
+     * Best-of-N timings on ~10^6 elements. The SIMD variant may be at most PerformanceTolerance 
+     * times slower than the scalar one, to absorb timer noise on memory bound kernels.
+     * For int only the mean has a SIMD path, the other kernels fall back to the scalar loops.
+    */
+    template <typename DataType>
+    void testSIMDNotSlower() {
+        using V = VectorUtils<DataType>;
+        const size_t size = 1 << 20;
+        std::vector<DataType> X = generate<DataType>(size, Regular);
+        std::vector<DataType> Y = generate<DataType>(size, Regular);
+        const DataType a = 2, b = DataType(0.5);
+
+        bool ok = true;
+        if constexpr (std::is_floating_point<DataType>::value) {
+            ok &= compareTimings<DataType>("LinearTransformation",
+                [&]() { return V::LinearTransformation(X, a, b)[size / 2]; },
+                [&]() { return V::LinearTransformationSIMD(X, a, b)[size / 2]; });
+            ok &= compareTimings<DataType>("Add(vector)",
+                [&]() { return V::Add(X, Y)[size / 2]; },
+                [&]() { return V::AddSIMD(X, Y)[size / 2]; });
+            ok &= compareTimings<DataType>("Add(scalar)",
+                [&]() { return V::Add(X, b)[size / 2]; },
+                [&]() { return V::AddSIMD(X, b)[size / 2]; });
+        }
+        ok &= compareTimings<DataType>("Mean",
+            [&]() { return V::Mean(X); },
+            [&]() { return V::MeanSIMD(X); });
+
+        assert(ok);
+    }
+
+private:
+    enum Distribution { Regular, Denormal, Extreme, IntegerValued };
+
+    static constexpr size_t MaxSize = 1000000;
+    static constexpr int RandomSizes = 8;
+    static constexpr int TimingRuns = 15;
+    static constexpr double PerformanceTolerance = 1.2;
+
+    std::mt19937_64 rng;
+
+    std::vector<size_t> sweepSizes() {
+        std::vector<size_t> sizes;
+        for (size_t size = 0; size <= 64; size++) {
+            sizes.push_back(size);
+        }
+        for (size_t power = 128; power <= MaxSize; power *= 2) {
+            sizes.insert(sizes.end(), {power - 1, power, power + 1});
+        }
+        std::uniform_int_distribution<size_t> randomSize(65, MaxSize);
+        for (int i = 0; i < RandomSizes; i++) {
+            sizes.push_back(randomSize(rng));
+        }
+        sizes.push_back(MaxSize);
+        return sizes;
+    }
+
+    template <typename DataType>
+    void checkAllKernels(size_t size, Distribution distribution) {
+        using D = KernelDifferential<DataType>;
+        std::vector<DataType> X = generate<DataType>(size, distribution);
+        std::vector<DataType> Y = generate<DataType>(size, distribution);
+        DataType a = generate<DataType>(1, distribution)[0];
+        DataType b = generate<DataType>(1, distribution)[0];
+
+        assert(D::CheckLinearTransformation(X, a, b));
+        assert(D::CheckAddVectors(X, Y));
+        assert(D::CheckAddScalar(X, b));
+
+        // Extreme values overflow the sum in an order dependent way, so they are excluded for the mean.
+        // Integer values keep every partial sum exact, so any dropped or repeated element shows up.
+        if (distribution == IntegerValued) {
+            assert(D::CheckMean(X, true));
+        } else if (distribution != Extreme) {
+            assert(D::CheckMean(X));
+        }
+    }
+
+    /**
+     * Integers are kept small enough for the sum of 10^6 of them to fit in an int. For floating 
+     * point, Denormal mixes subnormal numbers into regular ones and Extreme mixes in infinities, 
+     * NaN, signed zeros and the limits of the type. IntegerValued draws integers in [-8, 8], whose 
+     * sums over 10^6 elements stay below 2^24 and are therefore exact in float and double.
+    */
+    template <typename DataType>
+    std::vector<DataType> generate(size_t size, Distribution distribution) {
+        using Limits = std::numeric_limits<DataType>;
+        std::vector<DataType> values(size);
+
+        if constexpr (std::is_integral<DataType>::value) {
+            std::uniform_int_distribution<DataType> regular(-1000, 1000);
+            for (auto& v : values) {
+                v = regular(rng);
+            }
+        } else {
+            std::uniform_real_distribution<DataType> regular(-1000, 1000);
+            std::uniform_real_distribution<DataType> denormal(-Limits::min(), Limits::min());
+            const DataType extremes[] = {
+                Limits::max(), Limits::lowest(), Limits::min(), -Limits::min(), Limits::denorm_min(),
+                Limits::infinity(), -Limits::infinity(), Limits::quiet_NaN(), DataType(0), -DataType(0)
+            };
+            std::uniform_int_distribution<int> pick(0, 3);
+            std::uniform_int_distribution<size_t> pickExtreme(0, std::size(extremes) - 1);
+            std::uniform_int_distribution<int> integer(-8, 8);
+
+            for (auto& v : values) {
+                if (distribution == IntegerValued) {
+                    v = static_cast<DataType>(integer(rng));
+                } else if (distribution == Denormal && pick(rng) == 0) {
+                    v = denormal(rng);
+                } else if (distribution == Extreme && pick(rng) == 0) {
+                    v = extremes[pickExtreme(rng)];
+                } else {
+                    v = regular(rng);
+                }
+            }
+        }
+
+        return values;
+    }
+
+    template <typename DataType, typename Kernel>
+    static double bestTime(const Kernel& kernel) {
+        double best = std::numeric_limits<double>::max();
+        volatile DataType sink;
+        for (int run = 0; run < TimingRuns; run++) {
+            auto start = std::chrono::steady_clock::now();
+            sink = kernel();
+            auto end = std::chrono::steady_clock::now();
+            best = std::min(best, std::chrono::duration<double, std::micro>(end - start).count());
+        }
+        (void)sink;
+        return best;
+    }
+
+    template <typename DataType, typename Scalar, typename SIMD>
+    static bool compareTimings(const std::string& kernel, const Scalar& scalarKernel, const SIMD& simdKernel) {
+        const double scalar = bestTime<DataType>(scalarKernel);
+        const double simd = bestTime<DataType>(simdKernel);
+        const bool ok = simd <= scalar * PerformanceTolerance;
+
+        std::cout << std::left << std::setw(22) << kernel << std::setw(8) 
+            << (std::is_same<DataType, float>::value ? "float" : std::is_same<DataType, double>::value ? "double" : "int")
+            << "scalar " << std::setw(10) << scalar << "us SIMD " << std::setw(10) << simd << "us"
+            << (ok ? "" : "  SLOWER") << "\n";
+        return ok;
+    }
+};
+
+int main() {
+    VectorUtilsPropertyTest propertyTest;
+    propertyTest.testAll();
+}